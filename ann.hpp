@@ -7,7 +7,10 @@
 
 /* Inkluderingsdirektiv: */
 #include "dense_layer.hpp"
+#include "evaluation.hpp"
+#include "formatter.hpp"
 #include <vector>
+#include <string>
 #include <iostream>
 #include <cstdlib>
 
@@ -275,12 +278,104 @@ public:
       return this->output();
    }
 
+   /********************************************************************************
+   * predict: Genomfr prediktion fr samtliga uppsttningar i angiven vektor
+   *          via ett batchat framtpass genom lagren och lagrar predikterad
+   *          utdata i angiven vektor, en rad per uppsttning indata. Ntverkets
+   *          lagrade utsignaler pverkas inte.
+   *
+   *          - input : Referens till vektor innehllande indata.
+   *          - output: Referens till vektor dr predikterad utdata lagras.
+   ********************************************************************************/
+   void predict(const std::vector<std::vector<double>>& input,
+                std::vector<std::vector<double>>& output) const
+   {
+      std::vector<std::vector<double>> hidden;
+      this->hidden_layer_.feedforward(input, hidden);
+      this->output_layer_.feedforward(hidden, output);
+      return;
+   }
+
+   /********************************************************************************
+   * evaluate: Utvrderar angivet neuralt ntverk ver angiven datamngd via ett
+   *           batchat framtpass. Predikterad utdata, medelkvadratfel,
+   *           trffskerhet samt frvxlingsmatris returneras. Ifall ett ojmnt
+   *           antal uppsttningar passeras utvrderas endast de uppsttningar
+   *           som bestr av bde in- och utdata. Medelkvadratfelet berknas
+   *           ver de vrden som finns i bde predikterad och korrekt utdata,
+   *           och endast uppsttningar som ryms i frvxlingsmatrisen kan rknas
+   *           som korrekt klassade.
+   *
+   *           - input    : Referens till vektor innehllande indata.
+   *           - reference: Referens till vektor innehllande korrekta vrden.
+   ********************************************************************************/
+   evaluation evaluate(const std::vector<std::vector<double>>& input,
+                       const std::vector<std::vector<double>>& reference) const
+   {
+      evaluation result;
+      result.num_samples = input.size() < reference.size() ? input.size() : reference.size();
+
+      const auto num_classes = this->num_outputs() == 1 ? 2 : this->num_outputs();
+      result.confusion.resize(num_classes, std::vector<std::size_t>(num_classes, 0));
+      if (result.num_samples == 0 || this->num_outputs() == 0) return result;
+
+      if (input.size() == result.num_samples)
+      {
+         this->predict(input, result.predictions);
+      }
+      else
+      {
+         const std::vector<std::vector<double>> data(input.begin(), input.begin() + result.num_samples);
+         this->predict(data, result.predictions);
+      }
+
+      auto sum = 0.0;
+      std::size_t num_terms = 0;
+      std::size_t num_correct = 0;
+
+      for (std::size_t i = 0; i < result.num_samples; ++i)
+      {
+         const auto& prediction = result.predictions[i];
+         const auto& correct = reference[i];
+
+         for (std::size_t j = 0; j < prediction.size() && j < correct.size(); ++j)
+         {
+            const auto dev = correct[j] - prediction[j];
+            sum += dev * dev;
+            num_terms++;
+         }
+
+         const auto actual = evaluation::get_class(correct);
+         const auto predicted = evaluation::get_class(prediction);
+
+         if (actual < num_classes && predicted < num_classes)
+         {
+            result.confusion[actual][predicted]++;
+            if (actual == predicted) num_correct++;
+         }
+      }
+
+      if (num_terms) result.loss = sum / num_terms;
+      result.accuracy = static_cast<double>(num_correct) / result.num_samples;
+      return result;
+   }
+
+   /********************************************************************************
+   * evaluate: Utvrderar angivet neuralt ntverk ver samtliga befintliga
+   *           trningsuppsttningar via ett batchat framtpass.
+   ********************************************************************************/
+   evaluation evaluate(void) const
+   {
+      return this->evaluate(this->train_in_, this->train_out_);
+   }
+
    /********************************************************************************
    * print: Genomfr prediktion med indata frn angiven vektor och skriver ut 
    *        predikterad utdata via angiven utstrm, dr standardutenheten std::cout 
    *        anvnds som default fr utskrift i terminalen. Som default sker utskrift 
    *        med en decimal. Vrden mellan -0.001 samt 0.001 avrundas till noll vid 
-   *        utskrift.
+   *        utskrift. Prediktionen sker via ett batchat framtpass och utskriften
+   *        formateras till en strng som skrivs ut i ett svep.
    *
    *        - input       : Referens till vektor innehllande indata.
    *        - num_decimals: Antalet decimaler vid utskrift (default = 1).
@@ -291,12 +386,37 @@ public:
    void print(const std::vector<std::vector<double>>& input,
               const std::size_t num_decimals = 1,
               std::ostream& ostream = std::cout,
-              const double threshold = 0.001)
+              const double threshold = 0.001) const
    {
-      const auto& end = input[input.size() - 1];
       if (input.size() == 0) return;
-      ostream << "--------------------------------------------------------------------------------\n";
-      ostream << "--------------------------------------------------------------------------------\n\n";
+
+      std::vector<std::vector<double>> output;
+      this->predict(input, output);
+
+      std::string s;
+      s += "--------------------------------------------------------------------------------\n";
+
+      for (std::size_t i = 0; i < input.size(); ++i)
+      {
+         s += "Input: ";
+         for (auto& j : input[i])
+         {
+            formatter::append(s, j, num_decimals, threshold);
+            s += ' ';
+         }
+
+         s += "\nOutput: ";
+         for (auto& j : output[i])
+         {
+            formatter::append(s, j, num_decimals, threshold);
+            s += ' ';
+         }
+
+         s += i < input.size() - 1 ? "\n\n" : "\n";
+      }
+
+      s += "--------------------------------------------------------------------------------\n\n";
+      ostream.write(s.data(), static_cast<std::streamsize>(s.size()));
       return;
    }
 
@@ -314,7 +434,7 @@ public:
    ********************************************************************************/
    void print(const std::size_t num_decimals = 1,
               std::ostream& ostream = std::cout,
-              const double threshold = 0.001)
+              const double threshold = 0.001) const
    {
       this->print(this->train_in_, num_decimals, ostream, threshold);
       return;
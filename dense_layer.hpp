@@ -6,9 +6,11 @@
 #define DENSE_LAYER_HPP_
 
 /* Inkluderingsdirektiv: */
+#include "formatter.hpp"
+#include "thread_pool.hpp"
 #include <vector>
+#include <string>
 #include <iostream>
-#include <iomanip>
 #include <cstdlib>
 
 /********************************************************************************
@@ -114,6 +116,8 @@ struct dense_layer
 
    /********************************************************************************
    * print: Skriver ut flyttal frn angiven vektor p en rad via angiven utstrm.
+   *        Raden formateras frst till en strng via strukten formatter och
+   *        skrivs sedan ut i ett svep.
    *
    *        - data   : Referens till vektorn vars innehll ska skrivas ut.
    *        - ostream: Referens till angiven utstrm.
@@ -123,14 +127,17 @@ struct dense_layer
                      const std::size_t num_decimals = 1,
                      const double threshold = 0.001)
    {
-      ostream << std::fixed;
+      std::string line;
+      line.reserve(data.size() * (num_decimals + 4) + 1);
 
       for (auto& i : data)
       {
-         ostream << std::setprecision(num_decimals) << get_rounded(i, threshold) << " ";
+         formatter::append(line, i, num_decimals, threshold);
+         line += ' ';
       }
 
-      ostream << "\n";
+      line += '\n';
+      ostream.write(line.data(), static_cast<std::streamsize>(line.size()));
       return;
    }
 
@@ -173,22 +180,68 @@ struct dense_layer
    *              genom att summera respektive nods bias samt indata (vikter *
    *              nya insignaler). Om denna summa verstiger 0 s r noden 
    *              aktiverad och utsignalen stts till berknad summa. Annars r 
-   *              noden inaktiverad och utsignalen stts d till 0.
+   *              noden inaktiverad och utsignalen stts d till 0. Vid stora
+   *              lager frdelas noderna i block ver trdpoolen, se run_tiled.
    * 
    *              - input: Referens till vektor med nya insignaler.
    ********************************************************************************/
    void feedforward(const std::vector<double>& input)
    {
-      for (std::size_t i = 0; i < this->num_nodes(); ++i)
+      auto task = [&](const std::size_t begin, const std::size_t end)
       {
-         auto sum = this->bias[i];
-
-         for (std::size_t j = 0; j < this->num_weights() && j < input.size(); ++j)
+         for (std::size_t i = begin; i < end; ++i)
          {
-            sum += input[j] * this->weights[i][j];
+            auto sum = this->bias[i];
+
+            for (std::size_t j = 0; j < this->num_weights() && j < input.size(); ++j)
+            {
+               sum += input[j] * this->weights[i][j];
+            }
+
+            this->output[i] = this->relu(sum);
          }
+      };
+
+      this->run_tiled(this->num_weights(), task);
+      return;
+   }
+
+   /********************************************************************************
+   * feedforward: Berknar utsignaler fr samtliga noder i angivet dense-lager
+   *              fr en hel uppsttning indata i ett svep. Lagrets egna
+   *              utsignaler pverkas inte, istllet lagras resultatet i angiven
+   *              vektor, dr varje rad innehller utsignalerna fr motsvarande
+   *              rad indata. Yttre loopen gr ver raderna s att varje rad
+   *              indata lses en gng och ligger kvar i cacheminnet medan
+   *              samtliga noder berknas.
+   *
+   *              - input : Referens till vektor innehllande indata, en rad
+   *                        per uppsttning.
+   *              - output: Referens till vektor dr utsignalerna lagras.
+   ********************************************************************************/
+   void feedforward(const std::vector<std::vector<double>>& input,
+                    std::vector<std::vector<double>>& output) const
+   {
+      output.resize(input.size());
 
-         this->output[i] = this->relu(sum);
+      for (std::size_t i = 0; i < input.size(); ++i)
+      {
+         const auto& data = input[i];
+         auto& result = output[i];
+         result.resize(this->num_nodes());
+
+         for (std::size_t j = 0; j < this->num_nodes(); ++j)
+         {
+            const auto& weights = this->weights[j];
+            auto sum = this->bias[j];
+
+            for (std::size_t k = 0; k < weights.size() && k < data.size(); ++k)
+            {
+               sum += data[k] * weights[k];
+            }
+
+            result[j] = this->relu(sum);
+         }
       }
 
       return;
@@ -217,24 +270,29 @@ struct dense_layer
    * backpropagate: Berknar fel/avvikelser i angivet dolt lager via parametrar
    *                frn nsta/efterfljande lager. OBS! Denna medlemsfunktion
    *                r avsedd enbart fr dolda lager, se den alternativa
-   *                medlemsfunktionen med samma namn fr utgngslager.
+   *                medlemsfunktionen med samma namn fr utgngslager. Vid stora
+   *                lager frdelas noderna i block ver trdpoolen.
    *
    *                - next_layer: Referens till nsta/efterfljande dense-lager.
    ********************************************************************************/
    void backpropagate(const dense_layer& next_layer)
    {
-      for (std::size_t i = 0; i < this->num_nodes(); ++i)
+      auto task = [&](const std::size_t begin, const std::size_t end)
       {
-         auto dev = 0.0;
-
-         for (std::size_t j = 0; j < next_layer.num_nodes(); ++j)
+         for (std::size_t i = begin; i < end; ++i)
          {
-            dev += next_layer.error[j] * next_layer.weights[j][i];
-         }
+            auto dev = 0.0;
 
-         this->error[i] = dev * this->delta_relu(this->output[i]);
-      }
+            for (std::size_t j = 0; j < next_layer.num_nodes(); ++j)
+            {
+               dev += next_layer.error[j] * next_layer.weights[j][i];
+            }
+
+            this->error[i] = dev * this->delta_relu(this->output[i]);
+         }
+      };
 
+      this->run_tiled(next_layer.num_nodes(), task);
       return;
    }
 
@@ -268,6 +326,55 @@ struct dense_layer
    }
 
 private:
+   static constexpr std::size_t parallel_threshold_ = 1 << 16; /* Minsta antal multiplikationer fr parallell exekvering. */
+   static constexpr std::size_t tile_size_ = 32 * 1024;         /* Ungefrlig storlek p ett block i byte. */
+   static constexpr std::size_t min_tile_nodes_ = 8;            /* Minsta antal noder per block (en cacheline). */
+
+   /********************************************************************************
+   * run_tiled: Exekverar angiven uppgift fr samtliga noder i angivet dense-lager.
+   *            Om antalet multiplikationer understiger parallel_threshold_
+   *            exekveras uppgiften direkt i anropande trd. Annars delas noderna
+   *            upp i block vars data ryms i cacheminnet (ca tile_size_ byte),
+   *            som exekveras parallellt via den gemensamma trdpoolen. Antalet
+   *            noder per block avrundas uppt till en multipel av
+   *            min_tile_nodes_, s att varje block skriver minst en hel
+   *            cacheline med utsignaler/fel, vilket minskar false sharing
+   *            mellan trdar samt antalet atomiska operationer per nod. Varje
+   *            nod berknas av en och samma trd, s resultatet blir detsamma
+   *            som vid sekventiell exekvering.
+   *
+   *            - node_size: Antalet flyttal som lses per nod.
+   *            - task     : Referens till uppgiften, som anropas med intervallet
+   *                         [begin, end) av noder som ska berknas.
+   ********************************************************************************/
+   template <typename T>
+   void run_tiled(const std::size_t node_size,
+                  T& task) const
+   {
+      const auto num_nodes = this->num_nodes();
+
+      if (num_nodes < 2 || num_nodes * node_size < parallel_threshold_)
+      {
+         task(0, num_nodes);
+         return;
+      }
+
+      const auto cache_nodes = node_size * sizeof(double) < tile_size_ ?
+         tile_size_ / (node_size * sizeof(double)) : 1;
+      const auto tile_nodes = cache_nodes > min_tile_nodes_ ?
+         (cache_nodes + min_tile_nodes_ - 1) / min_tile_nodes_ * min_tile_nodes_ : min_tile_nodes_;
+      const auto num_tiles = (num_nodes + tile_nodes - 1) / tile_nodes;
+
+      auto tile_task = [&](const std::size_t tile)
+      {
+         const auto begin = tile * tile_nodes;
+         task(begin, begin + tile_nodes < num_nodes ? begin + tile_nodes : num_nodes);
+      };
+
+      thread_pool::instance().run(num_tiles, tile_task);
+      return;
+   }
+
    /********************************************************************************
    * get_random: Returnerar ett randomiserat flyttal mellan 0.0 - 1.0.
    ********************************************************************************/
@@ -308,29 +415,6 @@ private:
    {
       return output > 0.0 ? 1.0 : 0.0;
    }
-
-   /********************************************************************************
-   * get_rounded: Kontrollerar angivet flyttal och returnerar noll ifall detta
-   *              ligger inom angivet intervall [-threshold, threshold]. 
-   *              I praktiken gller drmed att flyttalet jmfrs med 
-   *              absolutbeloppet av angivet trskelvrde. Annars om flyttalet
-   *              i frga inte ligger inom intervallet returneras detta tal.
-   * 
-   *              - number   : Flyttalet som ska kontrolleras.
-   *              - threshold: Trskelvrdet som anvnds fr jmfrelse.
-   ********************************************************************************/
-   static double get_rounded(const double number,
-                             const double threshold = 0.001)
-   {
-      if (number > -threshold && number < threshold)
-      {
-         return 0;
-      }
-      else
-      {
-         return number;
-      }
-   }
 };
 
 #endif /* DENSE_LAYER_HPP_ */
\ No newline at end of file
@@ -0,0 +1,170 @@
+/********************************************************************************
+* evaluation.hpp: Innehller funktionalitet fr att lagra samt skriva ut
+*                 resultatet av en utvrdering av ett neuralt ntverk via
+*                 strukten evaluation.
+********************************************************************************/
+#ifndef EVALUATION_HPP_
+#define EVALUATION_HPP_
+
+/* Inkluderingsdirektiv: */
+#include "formatter.hpp"
+#include <vector>
+#include <string>
+#include <iostream>
+#include <cmath>
+#include <cstdlib>
+
+/********************************************************************************
+* evaluation: Strukt fr lagring av resultatet frn en utvrdering av ett
+*             neuralt ntverk ver en hel datamngd. Vid en utgng klassas
+*             utsignaler p minst 0.5 som klass 1, annars klass 0. Vid flera
+*             utgngar utgr index fr den strsta utsignalen klassen.
+*             Resultatet kan skrivas ut kompakt i CSV- eller JSON-format.
+********************************************************************************/
+struct evaluation
+{
+   std::vector<std::vector<double>> predictions;        /* Predikterad utdata per uppsttning. */
+   std::vector<std::vector<std::size_t>> confusion;     /* Frvxlingsmatris [faktisk][predikterad]. */
+   std::size_t num_samples = 0;                         /* Antalet utvrderade uppsttningar. */
+   double loss = 0.0;                                   /* Medelkvadratfelet (MSE). */
+   double accuracy = 0.0;                               /* Andelen korrekt klassade uppsttningar. */
+
+   /********************************************************************************
+   * get_class: Returnerar klassen fr angiven utdata. Vid en utgng returneras
+   *            1 om utsignalen r minst 0.5, annars 0. Vid flera utgngar
+   *            returneras index fr den strsta utsignalen.
+   *
+   *            - data: Referens till vektor innehllande utdata.
+   ********************************************************************************/
+   static std::size_t get_class(const std::vector<double>& data)
+   {
+      if (data.size() == 1) return data[0] >= 0.5 ? 1 : 0;
+      std::size_t max = 0;
+
+      for (std::size_t i = 1; i < data.size(); ++i)
+      {
+         if (data[i] > data[max]) max = i;
+      }
+
+      return max;
+   }
+
+   /********************************************************************************
+   * num_classes: Returnerar antalet klasser i frvxlingsmatrisen.
+   ********************************************************************************/
+   std::size_t num_classes(void) const
+   {
+      return this->confusion.size();
+   }
+
+   /********************************************************************************
+   * write_csv: Skriver ut sammanfattningen via angiven utstrm i CSV-format med
+   *            en rad per nyckel och vrde. Frvxlingsmatrisen skrivs ut som
+   *            nycklar p formen confusion_<faktisk>_<predikterad>. Icke-ndliga
+   *            vrden, exempelvis vid ett divergerande ntverk, skrivs ut som
+   *            nan, inf eller -inf.
+   *
+   *            - ostream     : Referens till angiven utstrm (default = std::cout).
+   *            - num_decimals: Antalet decimaler vid utskrift (default = 4).
+   ********************************************************************************/
+   void write_csv(std::ostream& ostream = std::cout,
+                  const std::size_t num_decimals = 4) const
+   {
+      std::string s;
+      s.reserve(64 + this->num_classes() * this->num_classes() * 24);
+
+      s += "key,value\nnum_samples,";
+      formatter::append(s, this->num_samples);
+      s += "\nloss,";
+      formatter::append(s, this->loss, num_decimals, 0.0);
+      s += "\naccuracy,";
+      formatter::append(s, this->accuracy, num_decimals, 0.0);
+      s += '\n';
+
+      for (std::size_t i = 0; i < this->num_classes(); ++i)
+      {
+         for (std::size_t j = 0; j < this->num_classes(); ++j)
+         {
+            s += "confusion_";
+            formatter::append(s, i);
+            s += '_';
+            formatter::append(s, j);
+            s += ',';
+            formatter::append(s, this->confusion[i][j]);
+            s += '\n';
+         }
+      }
+
+      ostream.write(s.data(), static_cast<std::streamsize>(s.size()));
+      return;
+   }
+
+   /********************************************************************************
+   * write_json: Skriver ut sammanfattningen via angiven utstrm som ett
+   *             JSON-objekt p en rad. Icke-ndliga vrden, exempelvis vid ett
+   *             divergerande ntverk, skrivs ut som null, d JSON saknar
+   *             motsvarighet till nan samt inf.
+   *
+   *             - ostream     : Referens till angiven utstrm (default = std::cout).
+   *             - num_decimals: Antalet decimaler vid utskrift (default = 4).
+   ********************************************************************************/
+   void write_json(std::ostream& ostream = std::cout,
+                   const std::size_t num_decimals = 4) const
+   {
+      std::string s;
+      s.reserve(96 + this->num_classes() * this->num_classes() * 8);
+
+      s += "{\"num_samples\":";
+      formatter::append(s, this->num_samples);
+      s += ",\"loss\":";
+      append_json(s, this->loss, num_decimals);
+      s += ",\"accuracy\":";
+      append_json(s, this->accuracy, num_decimals);
+      s += ",\"confusion_matrix\":[";
+
+      for (std::size_t i = 0; i < this->num_classes(); ++i)
+      {
+         if (i) s += ',';
+         s += '[';
+
+         for (std::size_t j = 0; j < this->num_classes(); ++j)
+         {
+            if (j) s += ',';
+            formatter::append(s, this->confusion[i][j]);
+         }
+
+         s += ']';
+      }
+
+      s += "]}\n";
+      ostream.write(s.data(), static_cast<std::streamsize>(s.size()));
+      return;
+   }
+
+private:
+   /********************************************************************************
+   * append_json: Lgger till angivet flyttal sist i angiven strng som ett
+   *              JSON-vrde. Icke-ndliga vrden lggs till som null.
+   *
+   *              - s           : Referens till strngen som talet ska lggas till i.
+   *              - number      : Flyttalet som ska lggas till.
+   *              - num_decimals: Antalet decimaler vid utskrift.
+   ********************************************************************************/
+   static void append_json(std::string& s,
+                           const double number,
+                           const std::size_t num_decimals)
+   {
+      if (std::isfinite(number))
+      {
+         formatter::append(s, number, num_decimals, 0.0);
+      }
+      else
+      {
+         s += "null";
+      }
+
+      return;
+   }
+};
+
+#endif /* EVALUATION_HPP_ */
\ No newline at end of file
@@ -0,0 +1,80 @@
+/********************************************************************************
+* formatter.hpp: Innehller funktionalitet fr snabb formatering av tal till
+*                text via strukten formatter, som anvnds vid utskrift istllet
+*                fr iostream-manipulatorer ssom std::setprecision.
+********************************************************************************/
+#ifndef FORMATTER_HPP_
+#define FORMATTER_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <string>
+#include <charconv>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+
+/********************************************************************************
+* formatter: Strukt innehllande statiska funktioner fr att lgga till tal i
+*            slutet av en strng via std::to_chars, vilket r betydligt
+*            snabbare n att skriva varje tal via en utstrm och avrundar p
+*            samma stt som std::setprecision. Strngen kan sedan skrivas till
+*            en utstrm i ett svep.
+********************************************************************************/
+struct formatter
+{
+   /********************************************************************************
+   * append: Lgger till angivet heltal sist i angiven strng.
+   *
+   *         - s     : Referens till strngen som talet ska lggas till i.
+   *         - number: Heltalet som ska lggas till.
+   ********************************************************************************/
+   static void append(std::string& s,
+                      const std::uint64_t number)
+   {
+      char buffer[20];
+      const auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+      s.append(buffer, result.ptr);
+      return;
+   }
+
+   /********************************************************************************
+   * append: Lgger till angivet flyttal med angivet antal decimaler sist i
+   *         angiven strng. Vrden mellan -threshold samt threshold avrundas
+   *         till noll. Icke-ndliga vrden skrivs ut som nan, inf eller -inf.
+   *         Om talet inte ryms i bufferten (mycket stora tal med mnga
+   *         decimaler) formateras det via std::snprintf.
+   *
+   *         - s           : Referens till strngen som talet ska lggas till i.
+   *         - number      : Flyttalet som ska lggas till.
+   *         - num_decimals: Antalet decimaler vid utskrift.
+   *         - threshold   : Trskelvrde som anvnds fr att avrunda tal nra
+   *                         noll (default = 0.001).
+   ********************************************************************************/
+   static void append(std::string& s,
+                      double number,
+                      const std::size_t num_decimals,
+                      const double threshold = 0.001)
+   {
+      if (number > -threshold && number < threshold) number = 0.0;
+
+      char buffer[128];
+      const auto result = std::to_chars(buffer, buffer + sizeof(buffer), number,
+                                        std::chars_format::fixed, static_cast<int>(num_decimals));
+
+      if (result.ec == std::errc())
+      {
+         s.append(buffer, result.ptr);
+      }
+      else
+      {
+         const auto length = std::snprintf(nullptr, 0, "%.*f", static_cast<int>(num_decimals), number);
+         std::string fallback(static_cast<std::size_t>(length) + 1, '\0');
+         std::snprintf(&fallback[0], fallback.size(), "%.*f", static_cast<int>(num_decimals), number);
+         s.append(fallback.data(), static_cast<std::size_t>(length));
+      }
+
+      return;
+   }
+};
+
+#endif /* FORMATTER_HPP_ */
\ No newline at end of file
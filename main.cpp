@@ -11,7 +11,8 @@
 *       i det enda ingngslagret och tv utgngsnoder. Ntverk trnas fr att 
 *       detektera ett 2-ingngars XOR-mnster under 1000 epoker med en 
 *       lrhastighet p 2 %. Efter trningen genomfrs prediktion samt utskrift
-*       med samtliga trningsuppsttningars insignaler som indata.
+*       med samtliga trningsuppsttningars insignaler som indata, fljt av en
+*       sammanfattning av utvrderingen i JSON-format.
 * 
 *       XOR-mnstret fr insignaler X1 och X2 samt utsignal Y visas nedan:
 *     
@@ -30,5 +31,6 @@ int main(void)
    ann1.set_training_data(train_in, train_out);
    ann1.train(1000, 0.02);
    ann1.print();
+   ann1.evaluate().write_json();
    return 0;
 }
\ No newline at end of file
@@ -0,0 +1,264 @@
+/********************************************************************************
+* thread_pool.hpp: Innehller funktionalitet fr parallell exekvering av
+*                  uppgifter uppdelade i block via klassen thread_pool.
+********************************************************************************/
+#ifndef THREAD_POOL_HPP_
+#define THREAD_POOL_HPP_
+
+/* Inkluderingsdirektiv: */
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
+
+/********************************************************************************
+* thread_pool: Klass fr implementering av en persistent trdpool, dr en
+*              gemensam instans skapas vid frsta anvndning och lever tills
+*              programmet avslutas. Arbetstrdarna snurrar en kort stund i
+*              vntan p nsta uppgift innan de parkeras via en
+*              villkorsvariabel, vilket ger lg latens vid tta anrop utan att
+*              processorkrnor upptas nr poolen inte anvnds. Anropande trd
+*              deltar sjlv i arbetet.
+*
+*              Aktuell krning beskrivs av ett 64-bitars tillstndsord
+*              innehllande krningens nummer (32 bitar), index fr nsta lediga
+*              fack (16 bitar) samt antalet fack (16 bitar). Fack hmtas via
+*              compare-and-swap, s en trd som vaknar sent kan endast hmta fack
+*              ur den krning som pgr. Anropande trd vntar drmed endast p
+*              fack som faktiskt exekveras, inte p att samtliga trdar vaknar.
+********************************************************************************/
+class thread_pool
+{
+private:
+   std::vector<std::thread> workers_;             /* Arbetstrdar. */
+   std::mutex run_mutex_;                         /* Tillter endast en krning t gngen. */
+   std::mutex park_mutex_;                        /* Mutex fr parkerade trdar. */
+   std::condition_variable park_condition_;       /* Vcker parkerade trdar. */
+   std::atomic<std::uint64_t> state_{ 0 };        /* Krning, nsta lediga fack samt antalet fack. */
+   std::atomic<std::size_t> num_done_{ 0 };       /* Antalet frdiga fack i aktuell krning. */
+   std::atomic<std::size_t> num_parked_{ 0 };     /* Antalet parkerade trdar. */
+   std::atomic<bool> stop_{ false };              /* Indikerar att trdarna ska avslutas. */
+   std::size_t num_blocks_ = 0;                   /* Antalet block i aktuell krning. */
+   std::size_t blocks_per_slot_ = 1;              /* Antalet block per fack i aktuell krning. */
+   void (*invoke_)(void*, std::size_t) = nullptr; /* Anropar aktuell uppgift fr ett block. */
+   void* task_ = nullptr;                         /* Pekare till aktuell uppgift. */
+
+   static constexpr std::size_t spin_count_ = 1 << 14;     /* Antalet varv innan parkering. */
+   static constexpr std::uint64_t slot_mask_ = 0xFFFF;     /* Mask fr fackflten i tillstndet. */
+   static constexpr std::uint64_t next_slot_ = 1ULL << 16; /* kning av nsta lediga fack. */
+
+   /********************************************************************************
+   * thread_pool: Skapar en arbetstrd per processorkrna utver anropande trd.
+   ********************************************************************************/
+   thread_pool(void)
+   {
+      const auto num_cores = std::thread::hardware_concurrency();
+
+      for (std::size_t i = 1; i < num_cores; ++i)
+      {
+         this->workers_.emplace_back(&thread_pool::work, this);
+      }
+
+      return;
+   }
+
+   /********************************************************************************
+   * pause: Signalerar till processorn att trden vntar i en snurrloop, vilket
+   *        minskar konkurrensen med en hypertrd p samma krna.
+   ********************************************************************************/
+   static inline void pause(void)
+   {
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+      _mm_pause();
+#elif defined(__i386__) || defined(__x86_64__)
+      __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+      __asm__ __volatile__("yield");
+#endif
+      return;
+   }
+
+   /********************************************************************************
+   * generation: Returnerar krningens nummer ur angivet tillstndsord.
+   *
+   *             - state: Tillstndsordet som ska avlsas.
+   ********************************************************************************/
+   static inline std::uint64_t generation(const std::uint64_t state)
+   {
+      return state >> 32;
+   }
+
+   /********************************************************************************
+   * execute_slots: Hmtar och exekverar lediga fack ur aktuell krning tills
+   *                samtliga fack har tagits. Returnerar numret p den krning
+   *                som senast observerades.
+   ********************************************************************************/
+   std::uint64_t execute_slots(void)
+   {
+      auto state = this->state_.load();
+
+      while (((state >> 16) & slot_mask_) < (state & slot_mask_))
+      {
+         if (!this->state_.compare_exchange_weak(state, state + next_slot_)) continue;
+
+         const auto slot = static_cast<std::size_t>((state >> 16) & slot_mask_);
+         const auto begin = slot * this->blocks_per_slot_;
+         const auto end = begin + this->blocks_per_slot_ < this->num_blocks_ ?
+            begin + this->blocks_per_slot_ : this->num_blocks_;
+
+         for (auto i = begin; i < end; ++i)
+         {
+            this->invoke_(this->task_, i);
+         }
+
+         this->num_done_++;
+         state = this->state_.load();
+      }
+
+      return generation(state);
+   }
+
+   /********************************************************************************
+   * wait_for_generation: Vntar p att en ny krning startas, alternativt att
+   *                      poolen ska avslutas. Trden snurrar frst en kort stund
+   *                      och parkeras sedan. Returnerar false om poolen avslutas.
+   *
+   *                      - seen: Numret p senast observerade krning.
+   ********************************************************************************/
+   bool wait_for_generation(const std::uint64_t seen)
+   {
+      for (std::size_t i = 0; i < spin_count_; ++i)
+      {
+         if (generation(this->state_) != seen || this->stop_) return !this->stop_;
+         if (i < spin_count_ / 2) pause();
+         else std::this_thread::yield();
+      }
+
+      std::unique_lock<std::mutex> lock(this->park_mutex_);
+      this->num_parked_++;
+      this->park_condition_.wait(lock, [&] { return generation(this->state_) != seen || this->stop_; });
+      this->num_parked_--;
+      return !this->stop_;
+   }
+
+   /********************************************************************************
+   * work: Huvudloop fr arbetstrdarna, exekverar lediga fack i varje ny krning
+   *       tills poolen avslutas.
+   ********************************************************************************/
+   void work(void)
+   {
+      auto seen = generation(this->state_);
+
+      while (this->wait_for_generation(seen))
+      {
+         seen = this->execute_slots();
+      }
+
+      return;
+   }
+
+public:
+   thread_pool(const thread_pool&) = delete;
+   thread_pool& operator=(const thread_pool&) = delete;
+
+   /********************************************************************************
+   * ~thread_pool: Avslutar och vntar in samtliga arbetstrdar.
+   ********************************************************************************/
+   ~thread_pool(void)
+   {
+      {
+         std::lock_guard<std::mutex> lock(this->park_mutex_);
+         this->stop_ = true;
+      }
+
+      this->park_condition_.notify_all();
+
+      for (auto& i : this->workers_)
+      {
+         i.join();
+      }
+
+      return;
+   }
+
+   /********************************************************************************
+   * instance: Returnerar en referens till den gemensamma trdpoolen, som skapas
+   *           vid frsta anropet.
+   ********************************************************************************/
+   static thread_pool& instance(void)
+   {
+      static thread_pool pool;
+      return pool;
+   }
+
+   /********************************************************************************
+   * num_threads: Returnerar antalet trdar som deltar i en krning, vilket r
+   *              antalet arbetstrdar samt anropande trd.
+   ********************************************************************************/
+   std::size_t num_threads(void) const
+   {
+      return this->workers_.size() + 1;
+   }
+
+   /********************************************************************************
+   * run: Exekverar angiven uppgift fr varje block i intervallet [0, num_blocks)
+   *      frdelat ver samtliga trdar och returnerar nr samtliga block r
+   *      klara. Blocken frdelas dynamiskt, s att trdar som blir klara
+   *      tidigt hmtar nsta lediga block. Om poolen redan anvnds av en
+   *      annan trd exekveras blocken direkt i anropande trd istllet fr att
+   *      vnta. OBS! Anrop fr inte ske inifrn en uppgift som exekveras av
+   *      poolen.
+   *
+   *      - num_blocks: Antalet block som ska exekveras.
+   *      - task      : Referens till uppgiften, som anropas med blockets index.
+   ********************************************************************************/
+   template <typename T>
+   void run(const std::size_t num_blocks,
+            T& task)
+   {
+      std::unique_lock<std::mutex> lock(this->run_mutex_, std::defer_lock);
+
+      if (this->workers_.empty() || num_blocks < 2 || !lock.try_lock())
+      {
+         for (std::size_t i = 0; i < num_blocks; ++i)
+         {
+            task(i);
+         }
+
+         return;
+      }
+
+      const auto num_slots = num_blocks < slot_mask_ ? num_blocks : static_cast<std::size_t>(slot_mask_);
+      this->invoke_ = [](void* task, const std::size_t block) { (*static_cast<T*>(task))(block); };
+      this->task_ = &task;
+      this->num_blocks_ = num_blocks;
+      this->blocks_per_slot_ = (num_blocks + num_slots - 1) / num_slots;
+      this->num_done_ = 0;
+      this->state_ = ((generation(this->state_) + 1) << 32) | num_slots;
+
+      if (this->num_parked_)
+      {
+         std::lock_guard<std::mutex> park_lock(this->park_mutex_);
+         this->park_condition_.notify_all();
+      }
+
+      this->execute_slots();
+
+      for (std::size_t i = 0; this->num_done_ < num_slots; ++i)
+      {
+         if (i < spin_count_) pause();
+         else std::this_thread::yield();
+      }
+
+      return;
+   }
+};
+
+#endif /* THREAD_POOL_HPP_ */
\ No newline at end of file